@@ -10,6 +10,41 @@ extends EditorPlugin
 # All utility functions are available as static methods on the FastWFC class.
 #
 
+const MONITOR_PREFIX = "FastWFC/"
+const STAT_PHASES = ["initialize", "generate", "interpret"]
+
+# Outcome of a generation request
+enum Status {
+	OK,               # Generation succeeded
+	FAILED,           # The solver hit a contradiction or was not initialized
+	CANCELLED,        # A CancellationToken was cancelled before the result was ready
+	TIMEOUT,          # The timeout elapsed before the result was ready
+	CONSTRAINT_UNMET, # Maps were generated, but none satisfied the constraints
+	INVALID_INPUT     # The config or arguments are unusable (unknown tile ID, rejected pin, ...)
+}
+
+static var _stats = {}
+static var _stats_mutex = Mutex.new()
+
+
+# Cancellation flag shared between a caller and running generation helpers
+#
+# Helpers check the token between native generate() calls; a single native
+# run cannot be interrupted once started. cancel() may be called from any thread.
+class CancellationToken:
+	signal cancelled
+	
+	var _cancelled = false
+	
+	func cancel() -> void:
+		if _cancelled:
+			return
+		_cancelled = true
+		cancelled.emit()
+	
+	func is_cancelled() -> bool:
+		return _cancelled
+
 
 func _enter_tree():
 	if not ClassDB.class_exists("FastWFCWrapper"):
@@ -339,6 +374,205 @@ static func _get_orientation_index(rotation_degrees: int) -> int:
 
 #endregion
 
+#region Socket Rule Functions
+
+# Builds tile data and adjacency rules from per-side socket labels
+#
+# Each tile declares the socket label of its sides in its base orientation.
+# Two oriented tiles may be placed next to each other when the touching sides
+# carry the same label. Oriented tiles are grouped by their left socket, so
+# matching pairs are found by lookup instead of testing every pair.
+#
+# initialize_tiling() expands every rule through all symmetry actions, so only
+# one representative is emitted per orbit of a pair under the actions that keep
+# it horizontal (identity, 180° rotation, reflection and their composition).
+#
+# Orientations in the rules follow the native convention of the tiling model:
+# 0-3 are 90° counter-clockwise rotations, 4-7 the same after a horizontal
+# reflection. interpret_tilemap_output() reports them in the clockwise marker
+# convention instead (see _to_native_orientation()).
+#
+# Parameters:
+#   socket_tiles: Dictionary mapping tile names to Dictionaries with:
+#     "sockets": Array of 4 labels [up, right, down, left]
+#     "id": Optional unique tile ID placed in the marker center (auto-generated if missing)
+#     "symmetry": Optional symmetry type (inferred from the sockets if missing)
+#     "weight": Optional weight (defaults to 1.0)
+# Returns: Dictionary with "tile_data" and "adjacency_rules" for WFC initialization
+#
+# Example:
+# [codeblock]
+# var rules = FastWFC.create_socket_rules({
+#     "grass": {"sockets": ["g", "g", "g", "g"]},
+#     "road": {"sockets": ["r", "g", "r", "g"]},
+# })
+# wfc.initialize_tiling(rules.tile_data, rules.adjacency_rules, width, height, periodic, seed)
+# [/codeblock]
+static func create_socket_rules(socket_tiles: Dictionary) -> Dictionary:
+	# Explicit IDs must be unique; auto-generated IDs skip them
+	var used_ids = {}
+	for tile_name in socket_tiles:
+		if "id" in socket_tiles[tile_name]:
+			var explicit_id = socket_tiles[tile_name]["id"]
+			if explicit_id in used_ids:
+				printerr("Duplicate socket tile ID " + str(explicit_id) + ": " + str(tile_name))
+				return {"tile_data": {}, "adjacency_rules": []}
+			used_ids[explicit_id] = true
+	
+	var tile_data = {}
+	var oriented_tiles = []
+	var tiles_by_left_socket = {}
+	var tile_offsets = {}
+	var tile_actions = {}
+	var counter = 0
+	
+	for tile_name in socket_tiles:
+		var tile = socket_tiles[tile_name]
+		var sockets = tile.get("sockets", [])
+		if sockets.size() != 4:
+			printerr("Socket tile needs exactly 4 sockets: " + str(tile_name))
+			continue
+		
+		var symmetry = tile.get("symmetry", _infer_socket_symmetry(sockets))
+		var tile_id = tile.get("id", -1)
+		if not "id" in tile:
+			while counter in used_ids:
+				counter += 1
+			tile_id = counter
+			used_ids[tile_id] = true
+		
+		tile_data[tile_name] = {
+			"content": [[0, 1, 2], [3, tile_id, 5], [6, 7, 8]],
+			"symmetry": symmetry,
+			"weight": tile.get("weight", 1.0)
+		}
+		tile_offsets[tile_name] = oriented_tiles.size()
+		tile_actions[tile_name] = _get_symmetry_action_maps(symmetry)
+		
+		for orientation in range(_get_symmetry_cardinality(symmetry)):
+			var sides = _orient_sockets(sockets, orientation)
+			oriented_tiles.append([tile_name, orientation, sides])
+			
+			var left_socket = sides[3]
+			if not left_socket in tiles_by_left_socket:
+				tiles_by_left_socket[left_socket] = []
+			tiles_by_left_socket[left_socket].append([tile_name, orientation])
+	
+	# Pair every oriented tile with the tiles whose left side matches its right side
+	var adjacency_rules = []
+	for oriented in oriented_tiles:
+		for neighbor in tiles_by_left_socket.get(oriented[2][1], []):
+			if not _is_canonical_pair(oriented[0], oriented[1], neighbor[0], neighbor[1], tile_offsets, tile_actions, oriented_tiles.size()):
+				continue
+			adjacency_rules.append({
+				"tile1": oriented[0],
+				"orientation1": oriented[1],
+				"tile2": neighbor[0],
+				"orientation2": neighbor[1]
+			})
+	
+	return {
+		"tile_data": tile_data,
+		"adjacency_rules": adjacency_rules
+	}
+
+# Checks whether a horizontal pair is the representative of its symmetry orbit
+#
+# The orbit is taken under the actions that map a horizontal pair to a
+# horizontal pair: 180° rotation and reflection swap the two tiles, their
+# composition (a vertical flip) keeps the order. The pair with the smallest
+# oriented-tile index key is the representative.
+#
+# Parameters:
+#   tile1, orientation1: Left oriented tile
+#   tile2, orientation2: Right oriented tile
+#   tile_offsets: Dictionary mapping tile names to their first oriented-tile index
+#   tile_actions: Dictionary mapping tile names to [rotation_map, reflection_map]
+#   oriented_count: Total number of oriented tiles
+# Returns: True if the pair should be emitted
+static func _is_canonical_pair(tile1: String, orientation1: int, tile2: String, orientation2: int, tile_offsets: Dictionary, tile_actions: Dictionary, oriented_count: int) -> bool:
+	var rotation1 = tile_actions[tile1][0]
+	var reflection1 = tile_actions[tile1][1]
+	var rotation2 = tile_actions[tile2][0]
+	var reflection2 = tile_actions[tile2][1]
+	var offset1 = tile_offsets[tile1]
+	var offset2 = tile_offsets[tile2]
+	
+	var rotated1 = rotation1[rotation1[orientation1]]
+	var rotated2 = rotation2[rotation2[orientation2]]
+	var key = (offset1 + orientation1) * oriented_count + offset2 + orientation2
+	var images = [
+		(offset2 + rotated2) * oriented_count + offset1 + rotated1,
+		(offset2 + reflection2[orientation2]) * oriented_count + offset1 + reflection1[orientation1],
+		(offset1 + reflection1[rotated1]) * oriented_count + offset2 + reflection2[rotated2]
+	]
+	for image in images:
+		if image < key:
+			return false
+	return true
+
+# Returns the socket labels of a tile after applying an orientation
+#
+# Parameters:
+#   sockets: Labels [up, right, down, left] in the base orientation
+#   orientation: Native orientation index (0-7), counting counter-clockwise turns
+# Returns: Labels [up, right, down, left] in the given orientation
+static func _orient_sockets(sockets: Array, orientation: int) -> Array:
+	var sides = sockets.duplicate()
+	if orientation >= 4:
+		sides = [sides[0], sides[3], sides[2], sides[1]]
+	
+	var rotated = []
+	for side in range(4):
+		rotated.append(sides[(side + orientation) % 4])
+	return rotated
+
+# Infers the symmetry type of a tile from its socket labels
+#
+# Only symmetries independent of the rotation direction are inferred;
+# any other tile uses "P", which enumerates all 8 orientations.
+#
+# Parameters:
+#   sockets: Labels [up, right, down, left] in the base orientation
+# Returns: Symmetry type ("X", "I", "T" or "P")
+static func _infer_socket_symmetry(sockets: Array) -> String:
+	if sockets[0] == sockets[1] and sockets[1] == sockets[2] and sockets[2] == sockets[3]:
+		return "X"
+	elif sockets[0] == sockets[2] and sockets[1] == sockets[3]:
+		return "I"
+	elif sockets[1] == sockets[3]:
+		return "T"
+	return "P"
+
+# Returns the number of distinct orientations of a symmetry type
+#
+# Parameters:
+#   symmetry: Symmetry type ("X", "I", "L", "T", "backslash", "P")
+# Returns: Number of orientations generated by the WFC algorithm
+static func _get_symmetry_cardinality(symmetry: String) -> int:
+	return _get_symmetry_action_maps(symmetry)[0].size()
+
+# Returns how a 90° rotation and a reflection permute the orientations of a symmetry type
+#
+# Mirrors the action maps the tiling model uses to expand neighbor rules.
+#
+# Parameters:
+#   symmetry: Symmetry type ("X", "I", "L", "T", "backslash", "P")
+# Returns: [rotation_map, reflection_map], each mapping orientation to orientation
+static func _get_symmetry_action_maps(symmetry: String) -> Array:
+	match symmetry:
+		"X": return [[0], [0]]
+		"I": return [[1, 0], [0, 1]]
+		"backslash", "\\": return [[1, 0], [1, 0]]
+		"T": return [[1, 2, 3, 0], [0, 3, 2, 1]]
+		"L": return [[1, 2, 3, 0], [1, 0, 3, 2]]
+		"P": return [[1, 2, 3, 0, 5, 6, 7, 4], [4, 7, 6, 5, 0, 3, 2, 1]]
+		_:
+			printerr("WARNING: Unexpected symmetry: " + symmetry)
+			return [[0], [0]]
+
+#endregion
+
 #region Overlapping Pattern Functions
 
 # Extracts color data from a texture for use with overlapping WFC
@@ -385,6 +619,7 @@ static func png_to_color_array(input_image_path: String) -> Array:
 #
 
 static func interpret_tilemap_output(result: Array) -> Array:
+	var start_usec = Time.get_ticks_usec()
 	var interpreted_result = []
 	var tile_size = 3  # Marker tiles are 3x3
 	
@@ -408,6 +643,7 @@ static func interpret_tilemap_output(result: Array) -> Array:
 		
 		interpreted_result.append(row)
 	
+	_record_timing("interpret", Time.get_ticks_usec() - start_usec)
 	return interpreted_result
 
 # Detects tile orientation from 3x3 marker pattern
@@ -448,6 +684,95 @@ static func _detect_orientation(tile_3x3: Array) -> int:
 		printerr("Warning: Unrecognized tile orientation pattern")
 		return 0
 
+# Converts an orientation from the marker convention of _detect_orientation() to the native one
+#
+# The native tiling model builds orientation k from k counter-clockwise turns,
+# while _detect_orientation() counts clockwise turns, so 1 and 3 (and 5 and 7)
+# are swapped. The mapping is its own inverse, so it also converts native
+# orientations to the marker convention.
+#
+# Parameters:
+#   orientation: Orientation index (0-7) as reported by interpret_tilemap_output()
+# Returns: Orientation index as expected by FastWFCWrapper.set_tile()
+static func _to_native_orientation(orientation: int) -> int:
+	return [0, 3, 2, 1, 4, 7, 6, 5][orientation]
+
+# Counts how often each tile ID occurs in an interpreted tiling result
+#
+# Parameters:
+#   result: Interpreted output from interpret_tilemap_output()
+# Returns: Dictionary mapping tile IDs to their number of occurrences
+static func count_tiles(result: Array) -> Dictionary:
+	var tile_counts = {}
+	for row in result:
+		for tile in row:
+			tile_counts[tile[0]] = tile_counts.get(tile[0], 0) + 1
+	return tile_counts
+
+# Counts the 4-connected components formed by a set of tile IDs
+#
+# Uses a union-find over the cells in a single scanline pass, joining each
+# matching cell with its left and upper neighbors. On periodic outputs, cells
+# in the last column and row are also joined with the first column and row.
+#
+# Parameters:
+#   result: Interpreted output from interpret_tilemap_output()
+#   tile_ids: Array of tile IDs that belong to the components (e.g. walkable tiles)
+#   periodic: Whether the output wraps around its edges
+# Returns: Number of connected components
+static func count_components(result: Array, tile_ids: Array, periodic: bool = false) -> int:
+	if result.is_empty():
+		return 0
+	
+	var included = {}
+	for tile_id in tile_ids:
+		included[tile_id] = true
+	
+	var width = result[0].size()
+	var height = result.size()
+	var parent = []
+	parent.resize(width * height)
+	parent.fill(-1)
+	var components = 0
+	
+	for y in range(height):
+		for x in range(width):
+			if not result[y][x][0] in included:
+				continue
+			var index = y * width + x
+			parent[index] = index
+			components += 1
+			
+			var neighbors = [index - 1 if x > 0 else -1, index - width if y > 0 else -1]
+			if periodic:
+				# The first column and row are already visited when the scan reaches the last ones
+				if x == width - 1:
+					neighbors.append(y * width)
+				if y == height - 1:
+					neighbors.append(x)
+			for neighbor in neighbors:
+				if neighbor == -1 or parent[neighbor] == -1:
+					continue
+				var root = _find_root(parent, neighbor)
+				var own_root = _find_root(parent, index)
+				if root != own_root:
+					parent[own_root] = root
+					components -= 1
+	
+	return components
+
+# Finds the union-find root of a cell, halving the path along the way
+#
+# Parameters:
+#   parent: Union-find parent array
+#   index: Cell index
+# Returns: Index of the root cell
+static func _find_root(parent: Array, index: int) -> int:
+	while parent[index] != index:
+		parent[index] = parent[parent[index]]
+		index = parent[index]
+	return index
+
 #endregion
 
 #region XML Parsing Functions
@@ -623,3 +948,938 @@ static func load_xml_rules(xml_path: String, tile_name_to_id: Dictionary = {}) -
 	}
 
 #endregion
+
+#region Generation Functions
+
+# Bundles tiling initialization arguments into a reusable config Dictionary
+#
+# A config captures every initialization argument except the seed, so the
+# generation helpers below can re-initialize wrappers with new seeds.
+#
+# Parameters:
+#   tile_data: Tile definitions as passed to FastWFCWrapper.initialize_tiling()
+#   adjacency_rules: Adjacency rules as passed to FastWFCWrapper.initialize_tiling()
+#   width: Output width in tiles
+#   height: Output height in tiles
+#   periodic: Whether the output wraps around its edges
+# Returns: Config Dictionary usable with initialize_from_config()
+static func create_tiling_config(tile_data: Dictionary, adjacency_rules: Array, width: int, height: int, periodic: bool) -> Dictionary:
+	return {
+		"type": "tiling",
+		"tile_data": tile_data,
+		"adjacency_rules": adjacency_rules,
+		"width": width,
+		"height": height,
+		"periodic": periodic
+	}
+
+# Bundles overlapping initialization arguments into a reusable config Dictionary
+#
+# Parameters:
+#   color_array: 2D array of Colors, e.g. from png_to_color_array()
+#   pattern_size: Size N of the extracted NxN patterns
+#   out_width: Output width in pixels
+#   out_height: Output height in pixels
+#   periodic_input: Whether the sample wraps around its edges
+#   periodic_output: Whether the output wraps around its edges
+#   ground: Whether the bottom pattern row is treated as ground
+#   symmetry: Number of pattern symmetries to use (1-8)
+# Returns: Config Dictionary usable with initialize_from_config()
+static func create_overlapping_config(color_array: Array, pattern_size: int, out_width: int, out_height: int, periodic_input: bool, periodic_output: bool, ground: bool, symmetry: int) -> Dictionary:
+	return {
+		"type": "overlapping",
+		"color_array": color_array,
+		"pattern_size": pattern_size,
+		"out_width": out_width,
+		"out_height": out_height,
+		"periodic_input": periodic_input,
+		"periodic_output": periodic_output,
+		"ground": ground,
+		"symmetry": symmetry
+	}
+
+# Initializes a FastWFCWrapper from a config Dictionary and a seed
+#
+# Parameters:
+#   wfc: The FastWFCWrapper instance to initialize
+#   config: Config from create_tiling_config() or create_overlapping_config()
+#   seed_value: Random seed for this run
+# Returns: True if the config type was recognized
+static func initialize_from_config(wfc: Object, config: Dictionary, seed_value: int) -> bool:
+	var start_usec = Time.get_ticks_usec()
+	match config.get("type", ""):
+		"tiling":
+			wfc.initialize_tiling(config.tile_data, config.adjacency_rules, config.width, config.height, config.periodic, seed_value)
+		"overlapping":
+			wfc.initialize_overlapping_from_array(config.color_array, config.pattern_size, config.out_width, config.out_height,
+				config.periodic_input, config.periodic_output, config.ground, config.symmetry, seed_value)
+		_:
+			printerr("Unknown WFC config type: " + str(config.get("type", "")))
+			return false
+	_record_timing("initialize", Time.get_ticks_usec() - start_usec)
+	return true
+
+# Initializes a wrapper from a config with the given seed and runs generate()
+#
+# The native initialize_* call runs in full on every call; this is a
+# convenience for the config-based helpers, not a cheaper re-run.
+#
+# Parameters:
+#   wfc: The FastWFCWrapper instance to initialize
+#   config: Config from create_tiling_config() or create_overlapping_config()
+#   seed_value: Random seed for this run
+# Returns: Raw generate() output, or an empty array on failure
+#
+# Example:
+# [codeblock]
+# var xml_data = FastWFC.load_xml_rules("res://data/tileset_rules.xml")
+# var config = FastWFC.create_tiling_config(xml_data.tile_data, xml_data.adjacency_rules, 32, 32, false)
+# for level_seed in [1, 2, 3]:
+#     var result = FastWFC.generate_from_config(wfc, config, level_seed)
+# [/codeblock]
+static func generate_from_config(wfc: Object, config: Dictionary, seed_value: int) -> Array:
+	if not initialize_from_config(wfc, config, seed_value):
+		return []
+	return timed_generate(wfc)
+
+# Calls generate() on a wrapper and records its timing in the stats
+#
+# Parameters:
+#   wfc: An initialized FastWFCWrapper instance
+# Returns: Raw generate() output, or an empty array on failure
+static func timed_generate(wfc: Object) -> Array:
+	var start_usec = Time.get_ticks_usec()
+	var result = wfc.generate()
+	_record_timing("generate", Time.get_ticks_usec() - start_usec)
+	if result.is_empty():
+		_increment_stat("failed_generations")
+	return result
+
+# Runs generate() on a worker thread and delivers the result on the main thread
+#
+# The callback runs on the main thread, so it can safely update nodes. It is
+# called exactly once: when the result is ready, when the timeout elapses or
+# when the token is cancelled, whichever comes first. A native run cannot be
+# interrupted, so after a timeout or cancellation it finishes in the background
+# and its result is discarded. The worker task is always reclaimed by the plugin.
+# The wrapper must not be used again until generate() would have returned.
+#
+# The timeout needs a SceneTree main loop for its timer. Under any other main
+# loop, a positive timeout_msec does not start the run; the callback receives
+# INVALID_INPUT instead.
+#
+# Parameters:
+#   wfc: An initialized FastWFCWrapper instance
+#   callback: Callable receiving the generation result Dictionary (see generate_with_status())
+#   timeout_msec: Maximum time to wait in milliseconds (0 waits without limit)
+#   token: Optional CancellationToken that ends the wait early
+#
+# Example:
+# [codeblock]
+# FastWFC.generate_async(wfc, _on_generated, 2000)
+#
+# func _on_generated(result: Dictionary):
+#     if result.status == FastWFC.Status.OK:
+#         _apply_result(result.data)
+# [/codeblock]
+static func generate_async(wfc: Object, callback: Callable, timeout_msec: int = 0, token: CancellationToken = null) -> void:
+	var start_usec = Time.get_ticks_usec()
+	var task_ids = []
+	var delivered = [false]
+	var on_cancelled = []
+	
+	# All of these run on the main thread, so `delivered` needs no lock
+	var deliver = func(status: Status, data: Array):
+		if delivered[0]:
+			return
+		delivered[0] = true
+		# A reused token must not keep this request's callback alive
+		if not on_cancelled.is_empty():
+			if token.cancelled.is_connected(on_cancelled[0]):
+				token.cancelled.disconnect(on_cancelled[0])
+			on_cancelled.clear()
+		callback.call(_make_result(status, data, start_usec))
+	
+	var main_loop = Engine.get_main_loop()
+	if timeout_msec > 0 and not main_loop is SceneTree:
+		printerr("generate_async needs a SceneTree main loop for timeout_msec")
+		deliver.call_deferred(Status.INVALID_INPUT, [])
+		return
+	
+	var complete = func(data: Array):
+		WorkerThreadPool.wait_for_task_completion(task_ids[0])
+		deliver.call(Status.OK if not data.is_empty() else Status.FAILED, data)
+	
+	var task = func():
+		complete.call_deferred(timed_generate(wfc))
+	task_ids.append(WorkerThreadPool.add_task(task, false, "FastWFC generation"))
+	
+	if token:
+		if token.is_cancelled():
+			deliver.call_deferred(Status.CANCELLED, [])
+		else:
+			on_cancelled.append(func(): deliver.call(Status.CANCELLED, []))
+			token.cancelled.connect(on_cancelled[0], CONNECT_DEFERRED | CONNECT_ONE_SHOT)
+	if timeout_msec > 0:
+		main_loop.create_timer(timeout_msec / 1000.0).timeout.connect(func(): deliver.call(Status.TIMEOUT, []))
+
+# Runs generate() with a wall-clock timeout and an optional cancellation token
+#
+# Blocks the calling thread until the result is ready, the timeout elapses or
+# the token is cancelled, so call it from a worker thread; on the main thread use
+# generate_async() instead. The worker posts a semaphore when it finishes; the
+# wait only wakes periodically while a deadline or token has to be checked.
+#
+# A native run cannot be interrupted: on timeout or cancellation it finishes in
+# the background, its result is discarded and its task is reclaimed on the main
+# thread. The wrapper must not be reused until generate() would have returned.
+#
+# Parameters:
+#   wfc: An initialized FastWFCWrapper instance
+#   timeout_msec: Maximum time to wait in milliseconds (0 waits without limit)
+#   token: Optional CancellationToken checked while waiting
+# Returns: Generation result Dictionary as described in generate_with_status()
+static func generate_with_timeout(wfc: Object, timeout_msec: int, token: CancellationToken = null) -> Dictionary:
+	var start_usec = Time.get_ticks_usec()
+	var state = {"data": [], "done": false, "abandoned": false}
+	var mutex = Mutex.new()
+	var semaphore = Semaphore.new()
+	var task_ids = []
+	
+	var task = func():
+		var data = timed_generate(wfc)
+		mutex.lock()
+		state.data = data
+		state.done = true
+		var abandoned = state.abandoned
+		mutex.unlock()
+		semaphore.post()
+		if abandoned:
+			(func(): WorkerThreadPool.wait_for_task_completion(task_ids[0])).call_deferred()
+	task_ids.append(WorkerThreadPool.add_task(task, false, "FastWFC generation"))
+	
+	if timeout_msec <= 0 and token == null:
+		semaphore.wait()
+	else:
+		var deadline = Time.get_ticks_msec() + timeout_msec
+		while not semaphore.try_wait():
+			var status = Status.OK
+			if token and token.is_cancelled():
+				status = Status.CANCELLED
+			elif timeout_msec > 0 and Time.get_ticks_msec() >= deadline:
+				status = Status.TIMEOUT
+			
+			if status != Status.OK:
+				mutex.lock()
+				var done = state.done
+				if not done:
+					state.abandoned = true
+				mutex.unlock()
+				if not done:
+					return _make_result(status, [], start_usec)
+				# The run finished while we were deciding; take its result
+				semaphore.wait()
+				break
+			
+			var remaining = deadline - Time.get_ticks_msec() if timeout_msec > 0 else 10
+			OS.delay_msec(clampi(remaining, 1, 10))
+	
+	WorkerThreadPool.wait_for_task_completion(task_ids[0])
+	return _make_result(Status.OK if not state.data.is_empty() else Status.FAILED, state.data, start_usec)
+
+# Runs generate() and reports the outcome as a structured result
+#
+# The result Dictionary contains:
+#   "status": Status of the run
+#   "status_name": Name of the status (e.g. "FAILED") for logging
+#   "data": Raw generate() output, empty unless the status is OK
+#   "elapsed_usec": Wall-clock time spent on the request in microseconds
+#
+# The retry-oriented helpers (generate_constrained(), regenerate_region(),
+# generate_hierarchical() and generate_weighted_regions()) return the same
+# shape with interpreted output as "data", plus "attempts" where they retry
+# with derived seeds. FAILED means every attempt hit a contradiction,
+# CONSTRAINT_UNMET that maps were generated but rejected, and INVALID_INPUT
+# that retrying with another seed cannot help.
+#
+# Parameters:
+#   wfc: An initialized FastWFCWrapper instance
+# Returns: Generation result Dictionary
+static func generate_with_status(wfc: Object) -> Dictionary:
+	var start_usec = Time.get_ticks_usec()
+	var result = timed_generate(wfc)
+	return _make_result(Status.OK if not result.is_empty() else Status.FAILED, result, start_usec)
+
+# Builds a generation result Dictionary
+#
+# Parameters:
+#   status: Status of the run
+#   data: Raw generate() output
+#   start_usec: Time.get_ticks_usec() at the start of the request
+#   extra: Additional helper-specific entries (e.g. "attempts")
+# Returns: Generation result Dictionary as described in generate_with_status()
+static func _make_result(status: Status, data: Array, start_usec: int, extra: Dictionary = {}) -> Dictionary:
+	var result = {
+		"status": status,
+		"status_name": Status.keys()[status],
+		"data": data,
+		"elapsed_usec": Time.get_ticks_usec() - start_usec
+	}
+	result.merge(extra)
+	return result
+
+# Generates one result per seed from a shared config using the WorkerThreadPool
+#
+# The config is only read by the workers. Each pool thread creates one
+# FastWFCWrapper and reuses it for every seed it runs, so independent seeds
+# run concurrently without per-seed wrapper churn.
+#
+# Parameters:
+#   config: Config from create_tiling_config() or create_overlapping_config()
+#   seeds: One seed per requested result
+#   threads: Maximum number of concurrent workers (-1 uses the pool default)
+#   token: Optional CancellationToken; seeds not started before cancellation are skipped
+# Returns: Generation result Dictionary (see generate_with_status()) whose "data" holds the
+#   raw generate() outputs in seed order, with an empty array for failed or skipped runs.
+#   The status is CANCELLED if any seed was skipped, FAILED if any run failed, OK otherwise.
+static func generate_batch(config: Dictionary, seeds: PackedInt64Array, threads: int = -1, token: CancellationToken = null) -> Dictionary:
+	var start_usec = Time.get_ticks_usec()
+	var results = []
+	results.resize(seeds.size())
+	if seeds.is_empty():
+		return _make_result(Status.OK, results, start_usec)
+	
+	# One wrapper per pool thread, keyed by the thread's caller ID
+	var wrappers = {}
+	var wrappers_mutex = Mutex.new()
+	# Lambdas capture locals by value, so the flag lives in a shared Array
+	var skipped = [false]
+	var task = func(index: int):
+		results[index] = []
+		if token and token.is_cancelled():
+			skipped[0] = true
+			return
+		var thread_id = OS.get_thread_caller_id()
+		wrappers_mutex.lock()
+		var wfc = wrappers.get(thread_id)
+		if wfc == null:
+			wfc = _create_wrapper()
+			wrappers[thread_id] = wfc
+		wrappers_mutex.unlock()
+		if wfc == null:
+			return
+		results[index] = generate_from_config(wfc, config, seeds[index])
+	
+	var tasks_needed = threads if threads > 0 else -1
+	var group_id = WorkerThreadPool.add_group_task(task, seeds.size(), tasks_needed, false, "FastWFC batch generation")
+	WorkerThreadPool.wait_for_group_task_completion(group_id)
+	
+	for wfc in wrappers.values():
+		if wfc != null:
+			_free_wrapper(wfc)
+	
+	var status = Status.OK
+	if skipped[0]:
+		status = Status.CANCELLED
+	elif results.any(func(result): return result.is_empty()):
+		status = Status.FAILED
+	return _make_result(status, results, start_usec)
+
+# Regenerates a rectangle of an interpreted tiling result and keeps the rest
+#
+# Runs WFC only on the rectangle plus a one-tile border. The border tiles are
+# pinned from the existing result with set_tile(), so the new patch connects
+# to its surroundings. On periodic configs, a region whose border wraps around
+# the map edge is regenerated over the whole periodic map with every other tile
+# pinned, so the wrap seam stays valid. Tiles are identified by the ID in their
+# marker center, so every tile in the config needs a unique ID.
+#
+# Parameters:
+#   config: Tiling config from create_tiling_config()
+#   result: Interpreted output from interpret_tilemap_output()
+#   rect: Region to regenerate, in tile coordinates
+#   seed_value: Random seed for the regenerated region
+# Returns: Generation result Dictionary (see generate_with_status()) whose "data" is a
+#   copy of result with the region replaced
+static func regenerate_region(config: Dictionary, result: Array, rect: Rect2i, seed_value: int) -> Dictionary:
+	var start_usec = Time.get_ticks_usec()
+	if config.get("type", "") != "tiling":
+		printerr("regenerate_region only works with tiling configs")
+		return _make_result(Status.INVALID_INPUT, [], start_usec)
+	if result.is_empty():
+		printerr("regenerate_region needs an existing result")
+		return _make_result(Status.INVALID_INPUT, [], start_usec)
+	
+	var bounds = Rect2i(0, 0, result[0].size(), result.size())
+	var region = rect.intersection(bounds)
+	if region.size.x <= 0 or region.size.y <= 0:
+		return _make_result(Status.OK, result.duplicate(true), start_usec)
+	
+	var patch = _generate_region_patch(config, result, region, seed_value, config.get("periodic", false))
+	if patch.status != Status.OK:
+		return _make_result(patch.status, [], start_usec)
+	
+	var new_result = result.duplicate(true)
+	_write_patch(new_result, patch.data, region.position)
+	return _make_result(Status.OK, new_result, start_usec)
+
+# Generates a large tiling map in two levels: a coarse meta map, then one block per meta tile
+#
+# The coarse config is generated first. Each coarse tile is then expanded into a
+# block_size x block_size block using the fine config registered for its tile ID.
+# Blocks are generated in a checkerboard order: all "black" blocks run in
+# parallel first, then all "white" blocks run in parallel with their borders
+# pinned from the finished black neighbors. Fine configs whose blocks can be
+# adjacent must share tile keys and IDs for the shared border tiles.
+#
+# Parameters:
+#   coarse_config: Tiling config for the meta map
+#   fine_configs: Dictionary mapping coarse tile IDs to tiling configs for their blocks
+#   block_size: Size of each block in tiles
+#   seed_value: Random seed for the whole map
+#   threads: Maximum number of concurrent workers (-1 uses the pool default)
+#   block_attempts: Number of seeds tried per block before giving up
+#   token: Optional CancellationToken checked before every block attempt
+# Returns: Generation result Dictionary (see generate_with_status()) whose "data" is the
+#   interpreted output of the full map. A failed block reports its own status, e.g.
+#   INVALID_INPUT for a coarse tile ID without a fine config.
+static func generate_hierarchical(coarse_config: Dictionary, fine_configs: Dictionary, block_size: int, seed_value: int, threads: int = -1, block_attempts: int = 3, token: CancellationToken = null) -> Dictionary:
+	var start_usec = Time.get_ticks_usec()
+	var wfc = _create_wrapper()
+	if wfc == null:
+		return _make_result(Status.FAILED, [], start_usec)
+	var coarse_raw = generate_from_config(wfc, coarse_config, seed_value)
+	_free_wrapper(wfc)
+	if coarse_raw.is_empty():
+		return _make_result(Status.FAILED, [], start_usec)
+	var coarse = interpret_tilemap_output(coarse_raw)
+	
+	var result = []
+	for y in range(coarse.size() * block_size):
+		var row = []
+		row.resize(coarse[0].size() * block_size)
+		result.append(row)
+	
+	for parity in range(2):
+		var blocks = []
+		for cy in range(coarse.size()):
+			for cx in range(coarse[cy].size()):
+				if (cx + cy) % 2 == parity:
+					blocks.append(Vector2i(cx, cy))
+		
+		# Workers only read result and write their own patch slot
+		var patches = []
+		patches.resize(blocks.size())
+		var task = func(index: int):
+			patches[index] = _make_result(Status.CANCELLED, [], start_usec)
+			var block = blocks[index]
+			var meta_id = coarse[block.y][block.x][0]
+			if not meta_id in fine_configs:
+				printerr("No fine config for coarse tile ID " + str(meta_id))
+				patches[index] = _make_result(Status.INVALID_INPUT, [], start_usec)
+				return
+			var region = Rect2i(block * block_size, Vector2i(block_size, block_size))
+			for attempt in range(block_attempts):
+				if token and token.is_cancelled():
+					return
+				var block_seed = hash([seed_value, block.x, block.y, attempt])
+				patches[index] = _generate_region_patch(fine_configs[meta_id], result, region, block_seed)
+				# Only a contradiction is worth another seed
+				if patches[index].status != Status.FAILED:
+					return
+		
+		if blocks.is_empty():
+			continue
+		var tasks_needed = threads if threads > 0 else -1
+		var group_id = WorkerThreadPool.add_group_task(task, blocks.size(), tasks_needed, false, "FastWFC hierarchical generation")
+		WorkerThreadPool.wait_for_group_task_completion(group_id)
+		
+		if token and token.is_cancelled():
+			return _make_result(Status.CANCELLED, [], start_usec)
+		for index in range(blocks.size()):
+			if patches[index].status != Status.OK:
+				return _make_result(patches[index].status, [], start_usec)
+			_write_patch(result, patches[index].data, blocks[index] * block_size)
+	
+	return _make_result(Status.OK, result, start_usec)
+
+# Generates the tiles of a region, pinning the surrounding tiles that are already set
+#
+# Parameters:
+#   config: Tiling config from create_tiling_config()
+#   result: Interpreted map; tiles around the region are pinned, null entries are left free
+#   region: Region to generate, inside the bounds of result
+#   seed_value: Random seed for this run
+#   periodic: Whether result wraps around its edges; a border that crosses an edge
+#     is then handled by generating the whole periodic map
+# Returns: Generation result Dictionary whose "data" holds the interpreted tiles of the region only
+static func _generate_region_patch(config: Dictionary, result: Array, region: Rect2i, seed_value: int, periodic: bool = false) -> Dictionary:
+	var bounds = Rect2i(0, 0, result[0].size(), result.size())
+	var padded = region.grow(1)
+	if periodic and not bounds.encloses(padded):
+		padded = bounds
+	else:
+		padded = padded.intersection(bounds)
+		periodic = false
+	
+	# Pin every known tile of the padded rectangle that lies outside the region
+	var pins = []
+	for y in range(padded.position.y, padded.end.y):
+		for x in range(padded.position.x, padded.end.x):
+			if not region.has_point(Vector2i(x, y)) and result[y][x] != null:
+				pins.append([x - padded.position.x, y - padded.position.y, result[y][x]])
+	if pins.is_empty() and not periodic:
+		padded = region
+	
+	var patch = _generate_tiling_with_pins(config, padded.size, pins, seed_value, periodic)
+	if patch.status != Status.OK:
+		return patch
+	
+	var offset = region.position - padded.position
+	var cropped = []
+	for y in range(region.size.y):
+		cropped.append(patch.data[offset.y + y].slice(offset.x, offset.x + region.size.x))
+	patch.data = cropped
+	return patch
+
+# Copies a patch of tiles into a map
+#
+# Parameters:
+#   result: Interpreted map to write into
+#   patch: Interpreted tiles to copy
+#   position: Top-left corner of the patch in the map
+static func _write_patch(result: Array, patch: Array, position: Vector2i) -> void:
+	for y in range(patch.size()):
+		for x in range(patch[y].size()):
+			result[position.y + y][position.x + x] = patch[y][x]
+
+# Generates a tiling map whose tile weights vary by region
+#
+# Each cell stores a small region index into a table of weight multipliers,
+# so biomes can share one rule set. The map is first generated with the
+# multipliers of region 0, then every other region is regenerated over its
+# bounding box with its own multipliers while all cells outside the region
+# are pinned, so region borders stay consistent with the rules. On periodic
+# outputs, a region whose border wraps around the map edge is regenerated
+# over the whole periodic map instead, so the wrap seam stays valid.
+#
+# Multipliers must be greater than zero; leave a tile out of the adjacency
+# rules instead of giving it a zero weight.
+#
+# Parameters:
+#   config: Tiling config from create_tiling_config()
+#   region_map: Region index per tile, row by row (width * height entries)
+#   weight_table: Array of Dictionaries mapping tile keys to weight multipliers, one per region
+#   seed_value: Random seed for the whole map
+#   attempts: Number of seeds tried for the base map and for each region before giving up
+# Returns: Generation result Dictionary (see generate_with_status()) whose "data" is the
+#   interpreted output and "attempts" the total number of runs
+static func generate_weighted_regions(config: Dictionary, region_map: PackedInt32Array, weight_table: Array, seed_value: int, attempts: int = 3) -> Dictionary:
+	var start_usec = Time.get_ticks_usec()
+	if config.get("type", "") != "tiling":
+		printerr("generate_weighted_regions only works with tiling configs")
+		return _make_result(Status.INVALID_INPUT, [], start_usec)
+	var size = Vector2i(config.width, config.height)
+	if region_map.size() != size.x * size.y:
+		printerr("Region map size does not match the output size")
+		return _make_result(Status.INVALID_INPUT, [], start_usec)
+	
+	var region_configs = []
+	for multipliers in weight_table:
+		var region_config = _scale_config_weights(config, multipliers)
+		if region_config.is_empty():
+			return _make_result(Status.INVALID_INPUT, [], start_usec)
+		region_configs.append(region_config)
+	if region_configs.is_empty():
+		region_configs.append(config)
+	
+	# Bounding box of every region that differs from the base region
+	var region_bounds = {}
+	for index in range(region_map.size()):
+		var region = region_map[index]
+		if region == 0:
+			continue
+		if region < 0 or region >= region_configs.size():
+			printerr("No weights for region " + str(region))
+			return _make_result(Status.INVALID_INPUT, [], start_usec)
+		var cell = Vector2i(index % size.x, floori(index / float(size.x)))
+		if region in region_bounds:
+			region_bounds[region] = region_bounds[region].expand(cell)
+		else:
+			region_bounds[region] = Rect2i(cell, Vector2i.ZERO)
+	
+	# Only a contradiction is worth another seed
+	var runs = 0
+	var base = {}
+	for attempt in range(attempts):
+		runs += 1
+		base = _generate_tiling_with_pins(region_configs[0], size, [], hash([seed_value, 0, attempt]), config.periodic)
+		if base.status != Status.FAILED:
+			break
+	if base.status != Status.OK:
+		return _make_result(base.status, [], start_usec, {"attempts": runs})
+	var result = base.data
+	
+	var bounds = Rect2i(Vector2i.ZERO, size)
+	for region in region_bounds:
+		var area = Rect2i(region_bounds[region].position, region_bounds[region].size + Vector2i.ONE).grow(1)
+		var periodic = false
+		if config.periodic and not bounds.encloses(area):
+			area = bounds
+			periodic = true
+		else:
+			area = area.intersection(bounds)
+		
+		var pins = []
+		for y in range(area.position.y, area.end.y):
+			for x in range(area.position.x, area.end.x):
+				if region_map[y * size.x + x] != region:
+					pins.append([x - area.position.x, y - area.position.y, result[y][x]])
+		
+		var patch = {}
+		for attempt in range(attempts):
+			runs += 1
+			patch = _generate_tiling_with_pins(region_configs[region], area.size, pins, hash([seed_value, region, attempt]), periodic)
+			if patch.status != Status.FAILED:
+				break
+		if patch.status != Status.OK:
+			return _make_result(patch.status, [], start_usec, {"attempts": runs})
+		for y in range(area.position.y, area.end.y):
+			for x in range(area.position.x, area.end.x):
+				if region_map[y * size.x + x] == region:
+					result[y][x] = patch.data[y - area.position.y][x - area.position.x]
+	
+	return _make_result(Status.OK, result, start_usec, {"attempts": runs})
+
+# Returns a copy of a tiling config with tile weights multiplied per tile key
+#
+# Parameters:
+#   config: Tiling config from create_tiling_config()
+#   multipliers: Dictionary mapping tile keys to weight multipliers (missing keys keep their weight)
+# Returns: New config sharing the adjacency rules of the original, or an empty Dictionary
+#   if a multiplier is not greater than zero
+static func _scale_config_weights(config: Dictionary, multipliers: Dictionary) -> Dictionary:
+	for tile_key in multipliers:
+		if not multipliers[tile_key] > 0.0:
+			printerr("Weight multiplier for tile " + str(tile_key) + " must be greater than zero")
+			return {}
+	if multipliers.is_empty():
+		return config
+	
+	var tile_data = {}
+	for tile_key in config.tile_data:
+		var tile = config.tile_data[tile_key].duplicate()
+		tile["weight"] = tile.get("weight", 1.0) * multipliers.get(tile_key, 1.0)
+		tile_data[tile_key] = tile
+	
+	var scaled_config = config.duplicate()
+	scaled_config.tile_data = tile_data
+	return scaled_config
+
+# Generates a tiling map that satisfies global constraints
+#
+# Supported constraints:
+#   "counts": Dictionary mapping tile IDs to {"min": int, "max": int} occurrence bounds
+#   "walkable": Array of tile IDs that must form a single 4-connected component
+#
+# Minimum counts are enforced before solving by pinning that many tiles of the
+# given ID at seeded random positions, so the solver builds the rest of the
+# map around them. Maximum counts and connectivity are checked on the result,
+# and the map is regenerated with a derived seed when a constraint fails.
+#
+# Parameters:
+#   config: Tiling config from create_tiling_config()
+#   constraints: Dictionary of constraints as described above
+#   seed_value: Random seed for the first attempt
+#   max_attempts: Number of seeds tried before giving up
+#   token: Optional CancellationToken checked before every attempt
+# Returns: Generation result Dictionary (see generate_with_status()) whose "data" is the
+#   interpreted output satisfying the constraints and "attempts" the number of runs.
+#   CONSTRAINT_UNMET means at least one map was generated but none satisfied the
+#   constraints; FAILED means every attempt hit a contradiction.
+#
+# Example:
+# [codeblock]
+# # Exactly one boss room (ID 7) and at most 40 water tiles (ID 2)
+# var result = FastWFC.generate_constrained(config, {"counts": {7: {"min": 1, "max": 1}, 2: {"max": 40}}}, seed)
+# if result.status == FastWFC.Status.OK:
+#     _apply_result(result.data)
+# [/codeblock]
+static func generate_constrained(config: Dictionary, constraints: Dictionary, seed_value: int, max_attempts: int = 10, token: CancellationToken = null) -> Dictionary:
+	var start_usec = Time.get_ticks_usec()
+	if config.get("type", "") != "tiling":
+		printerr("generate_constrained only works with tiling configs")
+		return _make_result(Status.INVALID_INPUT, [], start_usec)
+	
+	var size = Vector2i(config.width, config.height)
+	var counts = constraints.get("counts", {})
+	var required = 0
+	for tile_id in counts:
+		required += counts[tile_id].get("min", 0)
+	if required > size.x * size.y:
+		printerr("Minimum tile counts exceed the output size")
+		return _make_result(Status.INVALID_INPUT, [], start_usec)
+	
+	var tile_keys = _get_tile_keys_by_id(config.tile_data)
+	if tile_keys.is_empty():
+		return _make_result(Status.INVALID_INPUT, [], start_usec)
+	for tile_id in counts:
+		if not tile_id in tile_keys:
+			printerr("No tile with ID " + str(tile_id) + " in config")
+			return _make_result(Status.INVALID_INPUT, [], start_usec)
+	
+	var status = Status.FAILED
+	for attempt in range(max_attempts):
+		if token and token.is_cancelled():
+			return _make_result(Status.CANCELLED, [], start_usec, {"attempts": attempt})
+		var attempt_seed = hash([seed_value, attempt])
+		var pins = _get_minimum_count_pins(counts, config.tile_data, tile_keys, size, attempt_seed)
+		var result = _generate_tiling_with_pins(config, size, pins, attempt_seed, config.periodic)
+		if result.status == Status.INVALID_INPUT:
+			return _make_result(Status.INVALID_INPUT, [], start_usec, {"attempts": attempt + 1})
+		if result.status != Status.OK:
+			continue
+		if _satisfies_constraints(result.data, constraints, config.get("periodic", false)):
+			return _make_result(Status.OK, result.data, start_usec, {"attempts": attempt + 1})
+		status = Status.CONSTRAINT_UNMET
+	
+	return _make_result(status, [], start_usec, {"attempts": max_attempts})
+
+# Picks distinct random cells and orientations for the tiles required by minimum count constraints
+#
+# Parameters:
+#   counts: Dictionary mapping tile IDs to {"min": int, "max": int}
+#   tile_data: Tile definitions of the config
+#   tile_keys: Dictionary mapping tile IDs to tile keys, from _get_tile_keys_by_id()
+#   size: Output size in tiles
+#   seed_value: Seed for the cell and orientation selection
+# Returns: Array of [x, y, [source_id, orientation]] pins
+static func _get_minimum_count_pins(counts: Dictionary, tile_data: Dictionary, tile_keys: Dictionary, size: Vector2i, seed_value: int) -> Array:
+	var cells = range(size.x * size.y)
+	var rng = RandomNumberGenerator.new()
+	rng.seed = seed_value
+	
+	# Partial Fisher-Yates shuffle: only as many cells as pins are drawn
+	var pins = []
+	var next_cell = 0
+	for tile_id in counts:
+		var cardinality = _get_symmetry_cardinality(tile_data[tile_keys[tile_id]].get("symmetry", "X"))
+		for i in range(counts[tile_id].get("min", 0)):
+			var swap = rng.randi_range(next_cell, cells.size() - 1)
+			var cell = cells[swap]
+			cells[swap] = cells[next_cell]
+			cells[next_cell] = cell
+			next_cell += 1
+			# Pins use the marker convention, like interpreted results
+			var orientation = _to_native_orientation(rng.randi_range(0, cardinality - 1))
+			pins.append([cell % size.x, floori(cell / float(size.x)), [tile_id, orientation]])
+	return pins
+
+# Checks an interpreted result against the constraints of generate_constrained()
+#
+# Parameters:
+#   result: Interpreted output from interpret_tilemap_output()
+#   constraints: Dictionary of constraints
+#   periodic: Whether the output wraps around its edges
+# Returns: True if every constraint holds
+static func _satisfies_constraints(result: Array, constraints: Dictionary, periodic: bool = false) -> bool:
+	var counts = constraints.get("counts", {})
+	if not counts.is_empty():
+		var tile_counts = count_tiles(result)
+		for tile_id in counts:
+			var count = tile_counts.get(tile_id, 0)
+			if count < counts[tile_id].get("min", 0) or count > counts[tile_id].get("max", count):
+				return false
+	
+	if "walkable" in constraints and count_components(result, constraints.walkable, periodic) > 1:
+		return false
+	return true
+
+# Runs a tiling config at a given size with some tiles fixed in advance
+#
+# Parameters:
+#   config: Tiling config from create_tiling_config()
+#   size: Output size in tiles (overrides the config size)
+#   pins: Array of [x, y, [source_id, orientation]] entries to fix before generation, with
+#     orientations in the marker convention of interpret_tilemap_output()
+#   seed_value: Random seed for this run
+#   periodic: Whether the output wraps around its edges
+# Returns: Generation result Dictionary whose "data" is the interpreted output
+static func _generate_tiling_with_pins(config: Dictionary, size: Vector2i, pins: Array, seed_value: int, periodic: bool = false) -> Dictionary:
+	var start_usec = Time.get_ticks_usec()
+	var tile_keys = _get_tile_keys_by_id(config.tile_data)
+	if tile_keys.is_empty():
+		return _make_result(Status.INVALID_INPUT, [], start_usec)
+	var sub_config = config.duplicate()
+	sub_config.width = size.x
+	sub_config.height = size.y
+	sub_config.periodic = periodic
+	
+	var wfc = _create_wrapper()
+	if wfc == null:
+		return _make_result(Status.FAILED, [], start_usec)
+	initialize_from_config(wfc, sub_config, seed_value)
+	
+	for pin in pins:
+		var tile = pin[2]
+		if not tile[0] in tile_keys:
+			printerr("No tile with ID " + str(tile[0]) + " in config")
+			_free_wrapper(wfc)
+			return _make_result(Status.INVALID_INPUT, [], start_usec)
+		var orientation = _to_native_orientation(tile[1])
+		if not wfc.set_tile(tile_keys[tile[0]], orientation, pin[1], pin[0]):
+			printerr("Failed to pin tile " + str(tile_keys[tile[0]]) + " orientation " + str(orientation) + " at " + str(Vector2i(pin[0], pin[1])))
+			_free_wrapper(wfc)
+			return _make_result(Status.INVALID_INPUT, [], start_usec)
+	
+	var raw = timed_generate(wfc)
+	_free_wrapper(wfc)
+	if raw.is_empty():
+		return _make_result(Status.FAILED, [], start_usec)
+	return _make_result(Status.OK, interpret_tilemap_output(raw), start_usec)
+
+# Maps tile IDs (the marker center) back to their tile_data keys
+#
+# IDs must be unique: tile data from create_tilemap_data() uses the source ID as
+# tile ID, so several atlas tiles of one source cannot be told apart.
+#
+# Parameters:
+#   tile_data: Tile definitions as passed to FastWFCWrapper.initialize_tiling()
+# Returns: Dictionary mapping tile IDs to tile keys, or an empty Dictionary on duplicate IDs
+static func _get_tile_keys_by_id(tile_data: Dictionary) -> Dictionary:
+	var tile_keys = {}
+	for tile_key in tile_data:
+		var tile_id = tile_data[tile_key]["content"][1][1]
+		if tile_id in tile_keys:
+			printerr("Duplicate tile ID " + str(tile_id) + " for tiles " + str(tile_keys[tile_id]) + " and " + str(tile_key))
+			return {}
+		tile_keys[tile_id] = tile_key
+	return tile_keys
+
+# Creates a new FastWFCWrapper instance
+#
+# Returns: The wrapper, or null if the GDExtension is not loaded
+static func _create_wrapper() -> Object:
+	if not ClassDB.class_exists("FastWFCWrapper"):
+		printerr("FastWFCWrapper class not registered by GDExtension")
+		return null
+	return ClassDB.instantiate("FastWFCWrapper")
+
+# Releases a wrapper created by _create_wrapper()
+#
+# Parameters:
+#   wfc: The wrapper to release
+static func _free_wrapper(wfc: Object) -> void:
+	if not wfc is RefCounted:
+		wfc.free()
+
+#endregion
+
+#region Statistics Functions
+
+# Returns timing and counter statistics collected by the generation helpers
+#
+# For each phase ("initialize", "generate", "interpret") the Dictionary holds
+# "<phase>_count", "<phase>_usec" (total) and "last_<phase>_usec".
+# It also holds "failed_generations" and "process_peak_rss", the peak resident
+# memory of the whole process in bytes (including the native WFC buffers),
+# or -1 where the platform does not expose it.
+#
+# Returns: Dictionary of statistics
+static func get_stats() -> Dictionary:
+	_stats_mutex.lock()
+	var stats = _stats.duplicate()
+	_stats_mutex.unlock()
+	
+	for phase in STAT_PHASES:
+		for key in [phase + "_count", phase + "_usec", "last_" + phase + "_usec"]:
+			if not key in stats:
+				stats[key] = 0
+	if not "failed_generations" in stats:
+		stats["failed_generations"] = 0
+	stats["process_peak_rss"] = get_process_peak_rss()
+	return stats
+
+# Returns the peak resident set size of the whole process
+#
+# Reads VmHWM from /proc on Linux. The value is a process-wide high-water
+# mark and never decreases.
+#
+# Returns: Peak resident memory in bytes, or -1 if unavailable on this platform
+static func get_process_peak_rss() -> int:
+	var file = FileAccess.open("/proc/self/status", FileAccess.READ)
+	if file:
+		while not file.eof_reached():
+			var line = file.get_line()
+			if line.begins_with("VmHWM:"):
+				return line.trim_prefix("VmHWM:").strip_edges().split(" ")[0].to_int() * 1024
+	return -1
+
+# Clears all collected statistics
+static func reset_stats() -> void:
+	_stats_mutex.lock()
+	_stats.clear()
+	_stats_mutex.unlock()
+
+# Registers the collected statistics as custom Performance monitors
+#
+# Monitors are named "FastWFC/<phase>_ms" (duration of the last run of the phase),
+# "FastWFC/failed_generations" and "FastWFC/process_peak_rss". The phase and
+# failure monitors read single counters; only the RSS monitor reads /proc.
+static func register_performance_monitors() -> void:
+	for phase in STAT_PHASES:
+		_add_monitor(phase + "_ms", func(): return _get_stat("last_" + phase + "_usec") / 1000.0)
+	_add_monitor("failed_generations", func(): return _get_stat("failed_generations"))
+	_add_monitor("process_peak_rss", func(): return get_process_peak_rss())
+
+# Removes the monitors added by register_performance_monitors()
+static func unregister_performance_monitors() -> void:
+	var names = ["failed_generations", "process_peak_rss"]
+	for phase in STAT_PHASES:
+		names.append(phase + "_ms")
+	for monitor_name in names:
+		if Performance.has_custom_monitor(MONITOR_PREFIX + monitor_name):
+			Performance.remove_custom_monitor(MONITOR_PREFIX + monitor_name)
+
+# Adds a single custom Performance monitor if it is not registered yet
+#
+# Parameters:
+#   monitor_name: Monitor name without the "FastWFC/" prefix
+#   callable: Callable returning the monitor value
+static func _add_monitor(monitor_name: String, callable: Callable) -> void:
+	if not Performance.has_custom_monitor(MONITOR_PREFIX + monitor_name):
+		Performance.add_custom_monitor(MONITOR_PREFIX + monitor_name, callable)
+
+# Returns a single collected statistic without copying the whole Dictionary
+#
+# Parameters:
+#   key: Name of the statistic
+# Returns: Current value, or 0 if nothing was recorded yet
+static func _get_stat(key: String) -> int:
+	_stats_mutex.lock()
+	var value = _stats.get(key, 0)
+	_stats_mutex.unlock()
+	return value
+
+# Records the duration of one run of a phase
+#
+# Parameters:
+#   phase: Phase name from STAT_PHASES
+#   usec: Duration in microseconds
+static func _record_timing(phase: String, usec: int) -> void:
+	_stats_mutex.lock()
+	_stats[phase + "_count"] = _stats.get(phase + "_count", 0) + 1
+	_stats[phase + "_usec"] = _stats.get(phase + "_usec", 0) + usec
+	_stats["last_" + phase + "_usec"] = usec
+	_stats_mutex.unlock()
+
+# Increments a counter statistic by one
+#
+# Parameters:
+#   key: Name of the counter
+static func _increment_stat(key: String) -> void:
+	_stats_mutex.lock()
+	_stats[key] = _stats.get(key, 0) + 1
+	_stats_mutex.unlock()
+
+#endregion
@@ -0,0 +1,161 @@
+extends SceneTree
+
+# Fast WFC Benchmark
+#
+# Headless benchmark for the FastWFCWrapper GDExtension. Runs a fixed corpus of
+# overlapping samples and tiling rule sets at several output sizes and prints
+# one JSON object per case to stdout.
+#
+# Usage:
+#   godot --headless --path <project> --script res://addons/Godot_Fast_WFC/benchmark.gd
+#
+# Each line contains: case, width, height, runs, failed, init_ms, generate_ms
+# and cells_per_second. Width, height and cells count output cells: pixels for
+# overlapping cases, tiles for tiling cases. A final line reports
+# run_peak_rss, the process-wide peak resident memory in bytes (-1 if unavailable).
+#
+
+const FastWFC = preload("res://addons/Godot_Fast_WFC/FastWFC.gd")
+
+const OUTPUT_SIZES = [16, 32, 64]
+const RUNS_PER_CASE = 5
+const BASE_SEED = 12345
+
+
+func _init():
+	if not ClassDB.class_exists("FastWFCWrapper"):
+		printerr("FastWFCWrapper class not registered by GDExtension")
+		quit(1)
+		return
+	
+	var wfc = FastWFC._create_wrapper()
+	for size in OUTPUT_SIZES:
+		for case_name in _overlapping_samples():
+			var sample = _overlapping_samples()[case_name]
+			var config = FastWFC.create_overlapping_config(sample, 3, size, size, true, true, false, 8)
+			_run_case(wfc, "overlapping/" + case_name, config, size, size)
+	
+		for case_name in _tiling_rule_sets():
+			var rules = _tiling_rule_sets()[case_name]
+			var config = FastWFC.create_tiling_config(rules.tile_data, rules.adjacency_rules, size, size, false)
+			_run_case(wfc, "tiling/" + case_name, config, size, size)
+	FastWFC._free_wrapper(wfc)
+	
+	# VmHWM never resets, so only a run-wide peak is meaningful
+	print(JSON.stringify({"run_peak_rss": FastWFC.get_process_peak_rss()}))
+	quit()
+
+# Runs one benchmark case and prints its JSON line
+#
+# Parameters:
+#   wfc: FastWFCWrapper instance reused across runs
+#   case_name: Name reported in the output
+#   config: Generation config for the case
+#   width: Output width in cells (pixels or tiles)
+#   height: Output height in cells (pixels or tiles)
+func _run_case(wfc: Object, case_name: String, config: Dictionary, width: int, height: int) -> void:
+	var init_usec = 0
+	var generate_usec = 0
+	var failed = 0
+	
+	for run in range(RUNS_PER_CASE):
+		FastWFC.reset_stats()
+		FastWFC.initialize_from_config(wfc, config, BASE_SEED + run)
+		var result = FastWFC.timed_generate(wfc)
+		var stats = FastWFC.get_stats()
+		init_usec += stats.last_initialize_usec
+		generate_usec += stats.last_generate_usec
+		if result.is_empty():
+			failed += 1
+	
+	var cells = width * height * RUNS_PER_CASE
+	print(JSON.stringify({
+		"case": case_name,
+		"width": width,
+		"height": height,
+		"runs": RUNS_PER_CASE,
+		"failed": failed,
+		"init_ms": init_usec / 1000.0 / RUNS_PER_CASE,
+		"generate_ms": generate_usec / 1000.0 / RUNS_PER_CASE,
+		"cells_per_second": cells / max(generate_usec / 1000000.0, 0.000001)
+	}))
+
+# Builds the fixed corpus of overlapping samples
+#
+# Returns: Dictionary mapping case names to 2D Color arrays
+func _overlapping_samples() -> Dictionary:
+	var stripes = []
+	var checker = []
+	var rooms = []
+	for y in range(16):
+		var stripes_row = []
+		var checker_row = []
+		var rooms_row = []
+		for x in range(16):
+			stripes_row.append(Color.BLACK if floori(x / 2.0) % 2 == 0 else Color.WHITE)
+			checker_row.append(Color.BLACK if (floori(x / 4.0) + floori(y / 4.0)) % 2 == 0 else Color.WHITE)
+			if x % 8 == 0 or y % 8 == 0:
+				rooms_row.append(Color.BLACK)
+			elif x % 8 == 4 and y % 8 == 4:
+				rooms_row.append(Color.RED)
+			else:
+				rooms_row.append(Color.WHITE)
+		stripes.append(stripes_row)
+		checker.append(checker_row)
+		rooms.append(rooms_row)
+	
+	return {
+		"stripes": stripes,
+		"checker": checker,
+		"rooms": rooms
+	}
+
+# Builds the fixed corpus of tiling rule sets
+#
+# Returns: Dictionary mapping case names to {"tile_data", "adjacency_rules"}
+func _tiling_rule_sets() -> Dictionary:
+	return {
+		"two_tiles": _make_rule_set(
+			{"grass": "X", "water": "X"},
+			[["grass", 0, "grass", 0], ["grass", 0, "water", 0], ["water", 0, "water", 0]]
+		),
+		"lines": _make_rule_set(
+			{"empty": "X", "line": "I", "cross": "X"},
+			[
+				["empty", 0, "empty", 0], ["empty", 0, "line", 1], ["line", 1, "empty", 0],
+				["line", 0, "line", 0], ["line", 0, "cross", 0], ["cross", 0, "line", 0],
+				["line", 1, "line", 1]
+			]
+		)
+	}
+
+# Builds tile_data and adjacency_rules in the format of load_xml_rules()
+#
+# Parameters:
+#   symmetries: Dictionary mapping tile names to symmetry types
+#   neighbors: Array of [tile1, orientation1, tile2, orientation2] rules
+# Returns: Dictionary with "tile_data" and "adjacency_rules"
+func _make_rule_set(symmetries: Dictionary, neighbors: Array) -> Dictionary:
+	var tile_data = {}
+	var tile_id = 0
+	for tile_name in symmetries:
+		tile_data[tile_name] = {
+			"content": [[0, 1, 2], [3, tile_id, 5], [6, 7, 8]],
+			"symmetry": symmetries[tile_name],
+			"weight": 1.0
+		}
+		tile_id += 1
+	
+	var adjacency_rules = []
+	for neighbor in neighbors:
+		adjacency_rules.append({
+			"tile1": neighbor[0],
+			"orientation1": neighbor[1],
+			"tile2": neighbor[2],
+			"orientation2": neighbor[3]
+		})
+	
+	return {
+		"tile_data": tile_data,
+		"adjacency_rules": adjacency_rules
+	}
@@ -0,0 +1,145 @@
+extends SceneTree
+
+# Fast WFC Seam Test
+#
+# Headless check that the helpers which pin border tiles with set_tile() keep
+# their seams valid when the border holds rotated asymmetric tiles. Builds a
+# socket rule set with T and L tiles, then runs regenerate_region(),
+# generate_hierarchical() and generate_weighted_regions() and compares the
+# sockets of every pair of neighboring tiles.
+#
+# Usage:
+#   godot --headless --path <project> --script res://addons/Godot_Fast_WFC/seam_test.gd
+#
+# Prints one line per case and exits with code 1 if any case fails.
+#
+
+const FastWFC = preload("res://addons/Godot_Fast_WFC/FastWFC.gd")
+
+const SOCKET_TILES = {
+	"grass": {"sockets": ["g", "g", "g", "g"], "id": 0},
+	"road": {"sockets": ["r", "g", "r", "g"], "id": 1},
+	"tee": {"sockets": ["r", "r", "g", "r"], "id": 2},
+	"corner": {"sockets": ["r", "r", "g", "g"], "id": 3, "symmetry": "L"}
+}
+const MAP_SIZE = 12
+const SEEDS = [12345, 23456, 34567, 45678, 56789]
+
+
+func _init():
+	if not ClassDB.class_exists("FastWFCWrapper"):
+		printerr("FastWFCWrapper class not registered by GDExtension")
+		quit(1)
+		return
+	
+	var rules = FastWFC.create_socket_rules(SOCKET_TILES)
+	var config = FastWFC.create_tiling_config(rules.tile_data, rules.adjacency_rules, MAP_SIZE, MAP_SIZE, false)
+	var failed = 0
+	
+	var base = _generate_base(config)
+	if base.is_empty():
+		_report("base", "no seed produced a map with rotated T or L tiles")
+		quit(1)
+		return
+	failed += _check("base", {"status": FastWFC.Status.OK, "data": base})
+	
+	# The region border crosses rotated tiles of the base map
+	var rect = Rect2i(3, 3, 6, 6)
+	var regenerated = {}
+	for seed_value in SEEDS:
+		regenerated = FastWFC.regenerate_region(config, base, rect, seed_value)
+		if regenerated.status != FastWFC.Status.FAILED:
+			break
+	failed += _check("regenerate_region", regenerated)
+	if regenerated.status == FastWFC.Status.OK:
+		for y in range(MAP_SIZE):
+			for x in range(MAP_SIZE):
+				if not rect.has_point(Vector2i(x, y)) and regenerated.data[y][x] != base[y][x]:
+					_report("regenerate_region", "tile outside the region changed at " + str(Vector2i(x, y)))
+					failed += 1
+	
+	var coarse_rules = FastWFC.create_socket_rules({"block": {"sockets": ["b", "b", "b", "b"], "id": 100}})
+	var coarse_config = FastWFC.create_tiling_config(coarse_rules.tile_data, coarse_rules.adjacency_rules, 2, 2, false)
+	var fine_config = FastWFC.create_tiling_config(rules.tile_data, rules.adjacency_rules, 6, 6, false)
+	failed += _check("generate_hierarchical", FastWFC.generate_hierarchical(coarse_config, {100: fine_config}, 6, SEEDS[0]))
+	
+	var region_map = PackedInt32Array()
+	for y in range(MAP_SIZE):
+		for x in range(MAP_SIZE):
+			region_map.append(1 if x >= 4 and x < 8 and y >= 4 and y < 8 else 0)
+	failed += _check("generate_weighted_regions", FastWFC.generate_weighted_regions(config, region_map, [{}, {"tee": 4.0, "corner": 4.0}], SEEDS[0]))
+	
+	quit(1 if failed > 0 else 0)
+
+# Generates a base map that contains rotated asymmetric tiles
+#
+# Parameters:
+#   config: Tiling config of the socket rule set
+# Returns: Interpreted output, or an empty array if no seed produced one
+func _generate_base(config: Dictionary) -> Array:
+	var wfc = FastWFC._create_wrapper()
+	var base = []
+	for seed_value in SEEDS:
+		var raw = FastWFC.generate_from_config(wfc, config, seed_value)
+		if raw.is_empty():
+			continue
+		var result = FastWFC.interpret_tilemap_output(raw)
+		for row in result:
+			for tile in row:
+				if tile[0] >= 2 and tile[1] != 0:
+					base = result
+		if not base.is_empty():
+			break
+	FastWFC._free_wrapper(wfc)
+	return base
+
+# Checks a generation result and the sockets of all its neighboring tiles
+#
+# Parameters:
+#   case_name: Name reported in the output
+#   result: Generation result Dictionary
+# Returns: 1 if the case failed, 0 otherwise
+func _check(case_name: String, result: Dictionary) -> int:
+	if result.status != FastWFC.Status.OK:
+		_report(case_name, "status " + FastWFC.Status.keys()[result.status])
+		return 1
+	
+	var sockets_by_id = {}
+	for tile_name in SOCKET_TILES:
+		sockets_by_id[SOCKET_TILES[tile_name].id] = SOCKET_TILES[tile_name].sockets
+	
+	var map = result.data
+	var mismatches = 0
+	for y in range(map.size()):
+		for x in range(map[y].size()):
+			var sides = _get_sides(map[y][x], sockets_by_id)
+			if x + 1 < map[y].size() and sides[1] != _get_sides(map[y][x + 1], sockets_by_id)[3]:
+				mismatches += 1
+			if y + 1 < map.size() and sides[2] != _get_sides(map[y + 1][x], sockets_by_id)[0]:
+				mismatches += 1
+	
+	if mismatches > 0:
+		_report(case_name, str(mismatches) + " mismatched seams")
+		return 1
+	_report(case_name, "")
+	return 0
+
+# Returns the socket labels of an interpreted tile
+#
+# Parameters:
+#   tile: [source_id, orientation] entry of an interpreted result
+#   sockets_by_id: Dictionary mapping tile IDs to their base socket labels
+# Returns: Labels [up, right, down, left] of the placed tile
+func _get_sides(tile: Array, sockets_by_id: Dictionary) -> Array:
+	return FastWFC._orient_sockets(sockets_by_id[tile[0]], FastWFC._to_native_orientation(tile[1]))
+
+# Prints the outcome of a case
+#
+# Parameters:
+#   case_name: Name of the case
+#   error: Failure description, or an empty string if the case passed
+func _report(case_name: String, error: String) -> void:
+	if error.is_empty():
+		print("PASS " + case_name)
+	else:
+		printerr("FAIL " + case_name + ": " + error)